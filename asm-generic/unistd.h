@@ -691,9 +691,15 @@ __SC_COMP(__NR_process_vm_readv, sys_process_vm_readv, \
 #define __NR_process_vm_writev 271
 __SC_COMP(__NR_process_vm_writev, sys_process_vm_writev, \
           compat_sys_process_vm_writev)
+#define __NR_io_setup2 272
+__SC_COMP(__NR_io_setup2, sys_io_setup2, compat_sys_io_setup2)
+#define __NR_fsyncv 273
+__SYSCALL(__NR_fsyncv, sys_fsyncv)
+#define __NR_rseq 274
+__SYSCALL(__NR_rseq, sys_rseq)
 
 #undef __NR_syscalls
-#define __NR_syscalls 272
+#define __NR_syscalls 275
 
 /*
  * All syscalls below here should go away really,
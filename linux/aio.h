@@ -3,6 +3,7 @@
 
 #include <linux/list.h>
 #include <linux/workqueue.h>
+#include <linux/wait.h>
 #include <linux/aio_abi.h>
 #include <linux/uio.h>
 #include <linux/rcupdate.h>
@@ -34,6 +35,7 @@ struct kioctx;
 /* #define KIF_LOCKED		0 */
 #define KIF_KICKED		1
 #define KIF_CANCELLED		2
+#define KIF_NOWAIT		3	/* fail with -EAGAIN rather than block */
 
 #define kiocbTryLock(iocb)	test_and_set_bit(KIF_LOCKED, &(iocb)->ki_flags)
 #define kiocbTryKick(iocb)	test_and_set_bit(KIF_KICKED, &(iocb)->ki_flags)
@@ -41,6 +43,7 @@ struct kioctx;
 #define kiocbSetLocked(iocb)	set_bit(KIF_LOCKED, &(iocb)->ki_flags)
 #define kiocbSetKicked(iocb)	set_bit(KIF_KICKED, &(iocb)->ki_flags)
 #define kiocbSetCancelled(iocb)	set_bit(KIF_CANCELLED, &(iocb)->ki_flags)
+#define kiocbSetNowait(iocb)	set_bit(KIF_NOWAIT, &(iocb)->ki_flags)
 
 #define kiocbClearLocked(iocb)	clear_bit(KIF_LOCKED, &(iocb)->ki_flags)
 #define kiocbClearKicked(iocb)	clear_bit(KIF_KICKED, &(iocb)->ki_flags)
@@ -49,6 +52,7 @@ struct kioctx;
 #define kiocbIsLocked(iocb)	test_bit(KIF_LOCKED, &(iocb)->ki_flags)
 #define kiocbIsKicked(iocb)	test_bit(KIF_KICKED, &(iocb)->ki_flags)
 #define kiocbIsCancelled(iocb)	test_bit(KIF_CANCELLED, &(iocb)->ki_flags)
+#define kiocbIsNowait(iocb)	test_bit(KIF_NOWAIT, &(iocb)->ki_flags)
 
 /* is there a better place to document function pointer methods? */
 /**
@@ -119,6 +123,14 @@ struct kiocb {
 						 * for cancellation */
 	struct list_head	ki_batch;	/* batch allocation */
 
+	/*
+	 * Buffered reads and writes that would block on a locked page
+	 * queue this on the page's waitqueue (see lock_page_async()) and
+	 * return -EIOCBRETRY; aio_wake_function() kicks the iocb when the
+	 * page is unlocked instead of waking a sleeping submitter.
+	 */
+	struct wait_bit_queue	ki_wait;
+
 	/*
 	 * If the aio_resfd field of the userspace iocb is not zero,
 	 * this is the underlying eventfd context to deliver events to.
@@ -142,24 +154,6 @@ struct kiocb {
 		(x)->ki_user_data = 0;                  \
 	} while (0)
 
-#define AIO_RING_MAGIC			0xa10a10a1
-#define AIO_RING_COMPAT_FEATURES	1
-#define AIO_RING_INCOMPAT_FEATURES	0
-struct aio_ring {
-	unsigned	id;	/* kernel internal index number */
-	unsigned	nr;	/* number of io_events */
-	unsigned	head;
-	unsigned	tail;
-
-	unsigned	magic;
-	unsigned	compat_features;
-	unsigned	incompat_features;
-	unsigned	header_length;	/* size of aio_ring */
-
-
-	struct io_event		io_events[0];
-}; /* 128 bytes + ring size */
-
 #define aio_ring_avail(info, ring)	(((ring)->head + (info)->nr - 1 - (ring)->tail) % (info)->nr)
 
 #define AIO_RING_PAGES	8
@@ -176,6 +170,23 @@ struct aio_ring_info {
 	struct page		*internal_pages[AIO_RING_PAGES];
 };
 
+/* Submission ring state of an io_setup2() context, see aio_abi.h */
+struct aio_sq_info {
+	unsigned long		mmap_base;
+	unsigned long		mmap_size;
+
+	struct page		**ring_pages;
+	long			nr_pages;
+
+	unsigned		nr, head;
+
+	struct iocb __user	*iocbs;		/* indexed by ring entries */
+
+	struct task_struct	*thread;	/* IOCTX_FLAG_SQPOLL poller */
+	wait_queue_head_t	wait;
+	unsigned long		idle;		/* jiffies before poller sleeps */
+};
+
 struct kioctx {
 	atomic_t		users;
 	int			dead;
@@ -198,6 +209,10 @@ struct kioctx {
 
 	struct aio_ring_info	ring_info;
 
+	unsigned		flags;		/* IOCTX_FLAG_* */
+	unsigned		cq_batch;	/* completions per wakeup */
+	struct aio_sq_info	sq_info;
+
 	struct delayed_work	wq;
 
 	struct rcu_head		rcu_head;
@@ -211,6 +226,8 @@ extern ssize_t wait_on_sync_kiocb(struct kiocb *iocb);
 extern int aio_put_req(struct kiocb *iocb);
 extern void kick_iocb(struct kiocb *iocb);
 extern int aio_complete(struct kiocb *iocb, long res, long res2);
+extern int aio_wake_function(wait_queue_t *wait, unsigned mode,
+			     int sync, void *key);
 struct mm_struct;
 extern void exit_aio(struct mm_struct *mm);
 extern long do_io_submit(aio_context_t ctx_id, long nr,
@@ -51,8 +51,12 @@ enum {
  *
  * IOCB_FLAG_RESFD - Set if the "aio_resfd" member of the "struct iocb"
  *                   is valid.
+ * IOCB_FLAG_NOWAIT - Fail the iocb with -EAGAIN at submission time if
+ *                    it cannot be started without blocking (page cache
+ *                    miss, locked page, or filesystem lock contention).
  */
 #define IOCB_FLAG_RESFD		(1 << 0)
+#define IOCB_FLAG_NOWAIT	(1 << 1)
 
 /* read() from /dev/aio returns these structures. */
 struct io_event {
@@ -104,6 +108,95 @@ struct iocb {
 	__u32	aio_resfd;
 }; /* 64 bytes */
 
+/*
+ * Memory-mapped rings.
+ *
+ * Every kioctx has a completion ring mapped into the process at the
+ * address returned as the aio_context_t.  A context created by
+ * io_setup2() with IOCTX_FLAG_SQRING additionally gets a submission
+ * ring, mapped at aio_setup_params.sq_ring.
+ *
+ * Both rings follow the same protocol: the producer writes entries and
+ * then, after a write barrier, advances tail; the consumer reads entries
+ * between head and tail after a read barrier and then advances head.
+ * Indices wrap modulo nr.
+ *
+ * Submission ring: userspace produces (writes tail), the kernel
+ * consumes (writes head).
+ *
+ * Completion ring: the kernel produces (writes tail).  Completions may
+ * be reaped either by io_getevents(), which advances head in the kernel
+ * under the context's ring lock, or by userspace reading entries and
+ * advancing head itself, without a system call.  head is written by
+ * whichever side reaps.  The kernel does not serialize against
+ * userspace reaping, so a process must not reap from the mapped ring
+ * while io_getevents() may be running on the same context; it must
+ * pick one method per context, or serialize the two itself.
+ */
+#define AIO_RING_MAGIC			0xa10a10a1
+#define AIO_RING_COMPAT_FEATURES	1
+#define AIO_RING_INCOMPAT_FEATURES	0
+
+struct aio_ring {
+	__u32	id;	/* kernel internal index number */
+	__u32	nr;	/* number of io_events */
+	__u32	head;	/* written by the reaper, see above */
+	__u32	tail;	/* written by the kernel */
+
+	__u32	magic;
+	__u32	compat_features;
+	__u32	incompat_features;
+	__u32	header_length;	/* size of aio_ring */
+
+
+	struct io_event		io_events[0];
+}; /* 32 bytes + ring size */
+
+/*
+ * Submission ring: each entry is an index into the iocb array that was
+ * registered with io_setup2().
+ *
+ * AIO_SQ_NEED_WAKEUP is set by the kernel when the IOCTX_FLAG_SQPOLL
+ * thread has gone idle; userspace must then call io_submit() with
+ * nr == 0 to restart it after advancing tail.
+ */
+#define AIO_SQ_NEED_WAKEUP	(1 << 0)
+
+struct aio_sq_ring {
+	__u32	head;	/* written by the kernel */
+	__u32	tail;	/* written by userspace */
+	__u32	nr;	/* number of entries in array */
+	__u32	flags;	/* AIO_SQ_* */
+	__u32	dropped;	/* entries with an invalid iocb index */
+	__u32	reserved[3];
+
+	__u32	array[0];
+};
+
+/*
+ * Flags for aio_setup_params.flags.
+ *
+ * IOCTX_FLAG_SQRING - Map a submission ring in addition to the
+ *                     completion ring.
+ * IOCTX_FLAG_SQPOLL - Have a kernel thread poll the submission ring so
+ *                     that submission needs no system call while the
+ *                     thread is busy.  Implies IOCTX_FLAG_SQRING.
+ */
+#define IOCTX_FLAG_SQRING	(1 << 0)
+#define IOCTX_FLAG_SQPOLL	(1 << 1)
+
+struct aio_setup_params {
+	__u32	flags;		/* IOCTX_FLAG_* */
+	__u32	sq_entries;	/* size of the submission ring */
+	__u32	cq_batch;	/* completions to gather before waking waiters */
+	__s32	sq_thread_cpu;	/* CPU to bind the poll thread to, or -1 */
+	__u32	sq_thread_idle;	/* ms of idle polling before the thread sleeps */
+	__u32	reserved1;
+	__u64	iocbs;		/* user array of sq_entries struct iocb */
+	__u64	sq_ring;	/* out: address of the struct aio_sq_ring */
+	__u64	reserved2[2];
+};
+
 #undef IFBIG
 #undef IFLITTLE
 
@@ -233,6 +233,12 @@ struct compat_robust_list_head {
 	compat_uptr_t			list_op_pending;
 };
 
+struct compat_futex_wait_block {
+	compat_uptr_t	uaddr;
+	__u32		val;
+	__u32		bitset;
+};
+
 struct compat_statfs;
 struct compat_statfs64;
 struct compat_old_linux_dirent;
@@ -429,6 +435,9 @@ asmlinkage long compat_sys_fcntl64(unsigned int fd, unsigned int cmd,
 asmlinkage long compat_sys_fcntl(unsigned int fd, unsigned int cmd,
 				 unsigned long arg);
 asmlinkage long compat_sys_io_setup(unsigned nr_reqs, u32 __user *ctx32p);
+asmlinkage long compat_sys_io_setup2(unsigned nr_reqs,
+				     struct aio_setup_params __user *params,
+				     u32 __user *ctx32p);
 asmlinkage long compat_sys_io_getevents(aio_context_t ctx_id,
 					unsigned long min_nr,
 					unsigned long nr,
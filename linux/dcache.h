@@ -7,8 +7,10 @@
 #include <linux/rculist_bl.h>
 #include <linux/spinlock.h>
 #include <linux/seqlock.h>
+#include <linux/wait.h>
 #include <linux/cache.h>
 #include <linux/rcupdate.h>
+#include <linux/lockref.h>
 
 struct nameidata;
 struct path;
@@ -97,14 +99,16 @@ struct dentry {
 	unsigned char d_iname[DNAME_INLINE_LEN];	/* small names */
 
 	/* Ref lookup also touches following */
-	unsigned int d_count;		/* protected by d_lock */
-	spinlock_t d_lock;		/* per dentry lock */
+	struct lockref d_lockref;	/* per-dentry lock and refcount */
 	const struct dentry_operations *d_op;
 	struct super_block *d_sb;	/* The root of the dentry tree */
 	unsigned long d_time;		/* used by d_revalidate */
 	void *d_fsdata;			/* fs-specific data */
 
-	struct list_head d_lru;		/* LRU list */
+	union {
+		struct list_head d_lru;		/* LRU list */
+		wait_queue_head_t *d_wait;	/* in-lookup ones only */
+	};
 	/*
 	 * d_child and d_rcu can share memory
 	 */
@@ -113,9 +117,19 @@ struct dentry {
 	 	struct rcu_head d_rcu;
 	} d_u;
 	struct list_head d_subdirs;	/* our children */
-	struct list_head d_alias;	/* inode alias list */
+	union {
+		struct list_head d_alias;	/* inode alias list */
+		struct hlist_bl_node d_in_lookup_hash;	/* only for in-lookup ones */
+	};
 };
 
+#define d_lock	d_lockref.lock
+
+static inline unsigned d_count(const struct dentry *dentry)
+{
+	return dentry->d_lockref.count;
+}
+
 /*
  * dentry->d_lock spinlock nesting subclasses:
  *
@@ -188,6 +202,8 @@ struct dentry_operations {
 #define DCACHE_NEED_AUTOMOUNT	0x20000	/* handle automount on this dir */
 #define DCACHE_MANAGE_TRANSIT	0x40000	/* manage transit from this dirent */
 #define DCACHE_NEED_LOOKUP	0x80000 /* dentry requires i_op->lookup */
+#define DCACHE_PAR_LOOKUP	0x100000 /* being looked up (with parent
+					  * locked shared) */
 #define DCACHE_MANAGED_DENTRY \
 	(DCACHE_MOUNTED|DCACHE_NEED_AUTOMOUNT|DCACHE_MANAGE_TRANSIT)
 
@@ -212,6 +228,23 @@ extern void d_set_d_op(struct dentry *dentry, const struct dentry_operations *op
 /* allocate/de-allocate */
 extern struct dentry * d_alloc(struct dentry *, const struct qstr *);
 extern struct dentry * d_alloc_pseudo(struct super_block *, const struct qstr *);
+extern struct dentry * d_alloc_parallel(struct dentry *, const struct qstr *,
+					wait_queue_head_t *);
+extern void __d_lookup_done(struct dentry *);
+
+static inline int d_in_lookup(struct dentry *dentry)
+{
+	return dentry->d_flags & DCACHE_PAR_LOOKUP;
+}
+
+static inline void d_lookup_done(struct dentry *dentry)
+{
+	if (unlikely(d_in_lookup(dentry))) {
+		spin_lock(&dentry->d_lock);
+		__d_lookup_done(dentry);
+		spin_unlock(&dentry->d_lock);
+	}
+}
 extern struct dentry * d_splice_alias(struct inode *, struct dentry *);
 extern struct dentry * d_add_ci(struct dentry *, struct inode *, struct qstr *);
 extern struct dentry *d_find_any_alias(struct inode *inode);
@@ -300,7 +333,7 @@ static inline int __d_rcu_to_refcount(struct dentry *dentry, unsigned seq)
 	assert_spin_locked(&dentry->d_lock);
 	if (!read_seqcount_retry(&dentry->d_seq, seq)) {
 		ret = 1;
-		dentry->d_count++;
+		dentry->d_lockref.count++;
 	}
 
 	return ret;
@@ -334,17 +367,14 @@ extern char *dentry_path(struct dentry *, char *, int);
 static inline struct dentry *dget_dlock(struct dentry *dentry)
 {
 	if (dentry)
-		dentry->d_count++;
+		dentry->d_lockref.count++;
 	return dentry;
 }
 
 static inline struct dentry *dget(struct dentry *dentry)
 {
-	if (dentry) {
-		spin_lock(&dentry->d_lock);
-		dget_dlock(dentry);
-		spin_unlock(&dentry->d_lock);
-	}
+	if (dentry)
+		lockref_get(&dentry->d_lockref);
 	return dentry;
 }
 
@@ -381,6 +411,32 @@ static inline void dont_mount(struct dentry *dentry)
 
 extern void dput(struct dentry *);
 
+/**
+ * __d_rcu_to_refcount_lockless - take a refcount on an rcu-walk dentry
+ * @dentry: dentry to take a ref on
+ * @seq: seqcount to verify against
+ * Returns: 1 on success, 0 if no reference could be taken, or -1 if a
+ * reference was taken but @seq no longer matches.
+ *
+ * Like __d_rcu_to_refcount(), but called without d_lock: the reference
+ * is taken with lockref_get_not_dead(), which does not touch the lock
+ * when it is uncontended, and the sequence is rechecked afterwards.
+ *
+ * On -1 the reference is still held, since it may be the last one and
+ * dput() can sleep: the caller must drop it with dput() only after
+ * leaving rcu-walk (rcu_read_unlock() and vfsmount_lock), as
+ * unlazy_walk() and terminate_walk() do, and then fall back to ref-walk.
+ */
+static inline int __d_rcu_to_refcount_lockless(struct dentry *dentry,
+					       unsigned seq)
+{
+	if (unlikely(!lockref_get_not_dead(&dentry->d_lockref)))
+		return 0;
+	if (unlikely(read_seqcount_retry(&dentry->d_seq, seq)))
+		return -1;
+	return 1;
+}
+
 static inline bool d_managed(struct dentry *dentry)
 {
 	return dentry->d_flags & DCACHE_MANAGED_DENTRY;
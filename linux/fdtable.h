@@ -26,6 +26,7 @@ struct fdtable {
 	struct file __rcu **fd;      /* current fd array */
 	unsigned long *close_on_exec;
 	unsigned long *open_fds;
+	unsigned long *full_fds_bits;	/* bit n set: open_fds[n] is full */
 	struct rcu_head rcu;
 	struct fdtable *next;
 };
@@ -48,11 +49,15 @@ static inline bool close_on_exec(int fd, const struct fdtable *fdt)
 static inline void __set_open_fd(int fd, struct fdtable *fdt)
 {
 	__set_bit(fd, fdt->open_fds);
+	fd /= BITS_PER_LONG;
+	if (!~fdt->open_fds[fd])
+		__set_bit(fd, fdt->full_fds_bits);
 }
 
 static inline void __clear_open_fd(int fd, struct fdtable *fdt)
 {
 	__clear_bit(fd, fdt->open_fds);
+	__clear_bit(fd / BITS_PER_LONG, fdt->full_fds_bits);
 }
 
 static inline bool fd_is_open(int fd, const struct fdtable *fdt)
@@ -77,6 +82,7 @@ struct files_struct {
 	int next_fd;
 	unsigned long close_on_exec_init[1];
 	unsigned long open_fds_init[1];
+	unsigned long full_fds_bits_init[1];
 	struct file __rcu * fd_array[NR_OPEN_DEFAULT];
 };
 
@@ -94,6 +100,16 @@ struct vfsmount;
 struct dentry;
 
 extern int expand_files(struct files_struct *, int nr);
+/*
+ * Find the lowest free fd >= start, skipping words of open_fds that
+ * full_fds_bits marks as full.  open_fds and full_fds_bits are only
+ * modified under file_lock.  The search may also run under
+ * rcu_read_lock() alone, before file_lock is taken, but its result is
+ * then only a hint: under file_lock, alloc_fd() repeats the search if
+ * files->fdt has changed, files->next_fd has dropped below the hint or
+ * the slot is now open, and only then claims it with __set_open_fd().
+ */
+extern unsigned int find_next_fd(struct fdtable *fdt, unsigned int start);
 extern void free_fdtable_rcu(struct rcu_head *rcu);
 extern void __init files_defer_init(void);
 
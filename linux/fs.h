@@ -185,6 +185,10 @@ struct inodes_stat_t {
 #define FS_RENAME_DOES_D_MOVE	32768	/* FS will handle d_move()
 					 * during rename() internally.
 					 */
+#define FS_PARALLEL_DIROPS	65536	/* lookup/create/unlink of distinct
+					 * names may run concurrently in one
+					 * directory, see dir_lock_name().
+					 */
 
 /*
  * These are the fs-independent mount-flags: up to 32 flags are supported
@@ -379,6 +383,24 @@ struct inodes_stat_t {
 #define SYNC_FILE_RANGE_WRITE		2
 #define SYNC_FILE_RANGE_WAIT_AFTER	4
 
+/*
+ * One entry of the vector passed to fsyncv(2).  All ranges are written
+ * back in one pass, the journal commits covering them are waited on
+ * together and a single cache flush is issued per device.  A length of
+ * zero means to the end of the file.  The per-file result is returned
+ * in ret.
+ */
+struct fsync_range {
+	__s32	fd;
+	__u32	flags;		/* FSYNC_RANGE_* */
+	__u64	offset;
+	__u64	nbytes;
+	__s32	ret;		/* out: 0 or -errno for this file */
+	__u32	reserved;
+};
+
+#define FSYNC_RANGE_DATASYNC	1	/* fdatasync semantics */
+
 #ifdef __KERNEL__
 
 #include <linux/linkage.h>
@@ -401,6 +423,7 @@ struct inodes_stat_t {
 #include <linux/rculist_bl.h>
 #include <linux/atomic.h>
 #include <linux/shrinker.h>
+#include <linux/list_lru.h>
 #include <linux/migrate_mode.h>
 
 #include <asm/byteorder.h>
@@ -653,6 +676,7 @@ struct address_space {
 	struct mutex		i_mmap_mutex;	/* protect tree, count, list */
 	/* Protected by tree_lock together with the radix tree */
 	unsigned long		nrpages;	/* number of total pages */
+	unsigned long		nrshadows;	/* number of shadow entries */
 	pgoff_t			writeback_index;/* writeback starts here */
 	const struct address_space_operations *a_ops;	/* methods */
 	unsigned long		flags;		/* error bits/gfp mask */
@@ -834,6 +858,13 @@ struct inode {
 		struct pipe_inode_info	*i_pipe;
 		struct block_device	*i_bdev;
 		struct cdev		*i_cdev;
+		/*
+		 * Directories of FS_PARALLEL_DIROPS filesystems: taken
+		 * shared around operations on a single name (together
+		 * with that name's hashed lock), exclusive for
+		 * whole-directory ones.  See inode_alloc_dir_sem().
+		 */
+		struct rw_semaphore	*i_dir_sem;
 	};
 
 	__u32			i_generation;
@@ -947,6 +978,33 @@ struct fown_struct {
 	int signum;		/* posix.1b rt signal to be delivered on IO */
 };
 
+/*
+ * Additional readahead streams of a file.  When reads do not continue
+ * the primary window, the access is matched against these; each stream
+ * follows one sequential or constant-stride cursor, so interleaved
+ * scans of several regions of one file all get readahead.  Allocated
+ * on the first non-sequential miss and freed with the file.  The set
+ * hangs off struct file rather than file_ra_state, because
+ * file_ra_state is copied by value (e.g. nfsd's readahead cache) and
+ * must not carry owned pointers.
+ */
+#define RA_MAX_STREAMS	8
+
+struct ra_stream {
+	pgoff_t start;			/* where readahead started */
+	unsigned int size;		/* # of readahead pages */
+	unsigned int async_size;	/* as in file_ra_state */
+	pgoff_t prev_index;		/* last page read through this stream */
+	long stride;			/* pages between reads, 0 = sequential */
+	unsigned long last_used;	/* stamp for replacing the coldest */
+};
+
+struct ra_stream_set {
+	unsigned long clock;		/* bumped on every stream lookup */
+	unsigned int nr;		/* streams in use */
+	struct ra_stream streams[RA_MAX_STREAMS];
+};
+
 /*
  * Track a single file's readahead state
  */
@@ -959,6 +1017,10 @@ struct file_ra_state {
 	unsigned int ra_pages;		/* Maximum readahead window */
 	unsigned int mmap_miss;		/* Cache miss stat for mmap accesses */
 	loff_t prev_pos;		/* Cache last read() position */
+
+	/* Reported as ra_hits/ra_misses in /proc/<pid>/fdinfo/<fd> */
+	unsigned long hits;		/* reads served from readahead pages */
+	unsigned long misses;		/* reads that had to go to disk */
 };
 
 /*
@@ -1002,6 +1064,7 @@ struct file {
 	struct fown_struct	f_owner;
 	const struct cred	*f_cred;
 	struct file_ra_state	f_ra;
+	struct ra_stream_set	*f_ra_streams;	/* extra streams, may be NULL */
 
 	u64			f_version;
 #ifdef CONFIG_SECURITY
@@ -1447,14 +1510,14 @@ struct super_block {
 	struct list_head	s_files;
 #endif
 	struct list_head	s_mounts;	/* list of mounts; _not_ for fs use */
-	/* s_dentry_lru, s_nr_dentry_unused protected by dcache.c lru locks */
-	struct list_head	s_dentry_lru;	/* unused dentry lru */
-	int			s_nr_dentry_unused;	/* # of dentry on lru */
-
-	/* s_inode_lru_lock protects s_inode_lru and s_nr_inodes_unused */
-	spinlock_t		s_inode_lru_lock ____cacheline_aligned_in_smp;
-	struct list_head	s_inode_lru;		/* unused inode lru */
-	int			s_nr_inodes_unused;	/* # of inodes on lru */
+	/*
+	 * Unused dentries and inodes, sharded per NUMA node and per kmem
+	 * cgroup (list_lru_init_memcg), so s_shrink is SHRINKER_NUMA_AWARE
+	 * and SHRINKER_MEMCG_AWARE.  Keep them on their own cachelines;
+	 * they are hammered by dput/iput.
+	 */
+	struct list_lru		s_dentry_lru ____cacheline_aligned_in_smp;
+	struct list_lru		s_inode_lru ____cacheline_aligned_in_smp;
 
 	struct block_device	*s_bdev;
 	struct backing_dev_info *s_bdi;
@@ -1510,8 +1573,10 @@ struct super_block {
 };
 
 /* superblock cache pruning functions */
-extern void prune_icache_sb(struct super_block *sb, int nr_to_scan);
-extern void prune_dcache_sb(struct super_block *sb, int nr_to_scan);
+extern long prune_icache_sb(struct super_block *sb,
+			    struct shrink_control *sc);
+extern long prune_dcache_sb(struct super_block *sb,
+			    struct shrink_control *sc);
 
 extern struct timespec current_fs_time(struct super_block *sb);
 
@@ -1692,6 +1757,8 @@ struct super_operations {
 	void (*put_super) (struct super_block *);
 	void (*write_super) (struct super_block *);
 	int (*sync_fs)(struct super_block *sb, int wait);
+	int (*fsync_batch)(struct super_block *sb, struct file **files,
+			   struct fsync_range *ranges, unsigned int nr);
 	int (*freeze_fs) (struct super_block *);
 	int (*unfreeze_fs) (struct super_block *);
 	int (*statfs) (struct dentry *, struct kstatfs *);
@@ -1707,8 +1774,12 @@ struct super_operations {
 	ssize_t (*quota_write)(struct super_block *, int, const char *, size_t, loff_t);
 #endif
 	int (*bdev_try_to_free_page)(struct super_block*, struct page*, gfp_t);
-	int (*nr_cached_objects)(struct super_block *);
-	void (*free_cached_objects)(struct super_block *, int);
+	/*
+	 * Filesystem-private caches are not split per cgroup: these are
+	 * only called for global reclaim (shrink_control.memcg == NULL).
+	 */
+	long (*nr_cached_objects)(struct super_block *, int);
+	long (*free_cached_objects)(struct super_block *, long, int);
 };
 
 /*
@@ -1849,8 +1920,57 @@ struct file_system_type {
 	struct lock_class_key i_lock_key;
 	struct lock_class_key i_mutex_key;
 	struct lock_class_key i_mutex_dir_key;
+	struct lock_class_key i_dir_sem_key;
 };
 
+/*
+ * Directory locking for FS_PARALLEL_DIROPS filesystems.  Instead of
+ * serializing on the parent's i_mutex, an operation on one name takes
+ * the parent's i_dir_sem shared plus a lock hashed on (parent, name), so
+ * creates and unlinks of different names proceed in parallel.  Renames
+ * across directories, rmdir of the parent itself and readdir-vs-modify
+ * users take i_dir_sem exclusive.  The filesystem must do its own
+ * locking of the directory data structures (e.g. per htree block).
+ *
+ * i_dir_sem is allocated only for directories that use it, so inodes
+ * of other types and filesystems do not grow.  A FS_PARALLEL_DIROPS
+ * filesystem calls inode_alloc_dir_sem() on each directory inode while
+ * it is still I_NEW (including the root inode at mount), and evict()
+ * frees it again; it is never set or cleared on a live inode, so the
+ * choice of lock cannot change between lock and unlock.  If the
+ * allocation fails, or a path does not make the call, i_dir_sem stays
+ * NULL and that directory is serialized on i_mutex for its lifetime,
+ * exactly as on other filesystems; the filesystem need not fail the
+ * lookup, but its directory code must cope with both modes.
+ */
+extern int inode_alloc_dir_sem(struct inode *dir);
+extern void inode_free_dir_sem(struct inode *dir);
+
+static inline bool dir_has_parallel_ops(struct inode *dir)
+{
+	return (dir->i_sb->s_type->fs_flags & FS_PARALLEL_DIROPS) &&
+		S_ISDIR(dir->i_mode) && dir->i_dir_sem;
+}
+
+extern void dir_lock_name(struct inode *dir, const struct qstr *name);
+extern void dir_unlock_name(struct inode *dir, const struct qstr *name);
+
+static inline void dir_lock_exclusive(struct inode *dir)
+{
+	if (dir_has_parallel_ops(dir))
+		down_write(dir->i_dir_sem);
+	else
+		mutex_lock_nested(&dir->i_mutex, I_MUTEX_PARENT);
+}
+
+static inline void dir_unlock_exclusive(struct inode *dir)
+{
+	if (dir_has_parallel_ops(dir))
+		up_write(dir->i_dir_sem);
+	else
+		mutex_unlock(&dir->i_mutex);
+}
+
 extern struct dentry *mount_ns(struct file_system_type *fs_type, int flags,
 	void *data, int (*fill_super)(struct super_block *, void *, int));
 extern struct dentry *mount_bdev(struct file_system_type *fs_type,
@@ -2204,6 +2324,8 @@ extern int filemap_fdatawrite_range(struct address_space *mapping,
 extern int vfs_fsync_range(struct file *file, loff_t start, loff_t end,
 			   int datasync);
 extern int vfs_fsync(struct file *file, int datasync);
+extern int vfs_fsync_batch(struct file **files, struct fsync_range *ranges,
+			   unsigned int nr);
 extern int generic_write_sync(struct file *file, loff_t pos, loff_t count);
 extern void sync_supers(void);
 extern void emergency_sync(void);
@@ -20,6 +20,7 @@
 #define FUTEX_WAKE_BITSET	10
 #define FUTEX_WAIT_REQUEUE_PI	11
 #define FUTEX_CMP_REQUEUE_PI	12
+#define FUTEX_WAIT_MULTIPLE	13
 
 #define FUTEX_PRIVATE_FLAG	128
 #define FUTEX_CLOCK_REALTIME	256
@@ -39,6 +40,30 @@
 					 FUTEX_PRIVATE_FLAG)
 #define FUTEX_CMP_REQUEUE_PI_PRIVATE	(FUTEX_CMP_REQUEUE_PI | \
 					 FUTEX_PRIVATE_FLAG)
+#define FUTEX_WAIT_MULTIPLE_PRIVATE	(FUTEX_WAIT_MULTIPLE | \
+					 FUTEX_PRIVATE_FLAG)
+
+/*
+ * Argument array for FUTEX_WAIT_MULTIPLE: uaddr points to an array of
+ * val of these, and the timeout is given as for FUTEX_WAIT_BITSET.  The
+ * caller is queued on the hash bucket of every futex before any of the
+ * values is compared, so a wakeup racing with the call is not lost.  On
+ * wakeup the index of the futex that was woken is returned; if any
+ * *uaddr != val at entry, -EWOULDBLOCK is returned instead.
+ *
+ * NOTE: this structure is part of the syscall ABI, and must not be
+ * changed.
+ */
+struct futex_wait_block {
+	__u32 __user *uaddr;
+	__u32 val;
+	__u32 bitset;
+};
+
+/*
+ * Maximum number of futexes FUTEX_WAIT_MULTIPLE will wait on at once.
+ */
+#define FUTEX_MULTIPLE_MAX_COUNT	128
 
 /*
  * Support for robust futexes: the kernel cleans up held futexes at
@@ -124,6 +149,8 @@ struct robust_list_head {
 #define FUTEX_BITSET_MATCH_ANY	0xffffffff
 
 #ifdef __KERNEL__
+#include <linux/errno.h>
+
 struct inode;
 struct mm_struct;
 struct task_struct;
@@ -185,6 +212,36 @@ static inline void exit_pi_state_list(struct task_struct *curr)
 {
 }
 #endif
+
+/*
+ * The global futex hash is sized at boot to a power of two proportional
+ * to num_possible_cpus() (the "futex_hash_size=" parameter overrides it),
+ * and its buckets are cacheline aligned.  Each bucket keeps an atomic
+ * waiter count, so FUTEX_WAKE on a futex nobody waits on returns without
+ * taking the bucket lock.
+ *
+ * A process may instead hash its FUTEX_PRIVATE_FLAG futexes into a
+ * table of its own (prctl PR_FUTEX_HASH), so that it does not contend
+ * with unrelated processes for buckets.
+ */
+#ifdef CONFIG_FUTEX_PRIVATE_HASH
+struct futex_private_hash;
+
+extern void futex_mm_init(struct mm_struct *mm);
+extern void futex_hash_free(struct mm_struct *mm);
+extern int futex_hash_prctl(unsigned long arg2, unsigned long arg3);
+#else
+static inline void futex_mm_init(struct mm_struct *mm)
+{
+}
+static inline void futex_hash_free(struct mm_struct *mm)
+{
+}
+static inline int futex_hash_prctl(unsigned long arg2, unsigned long arg3)
+{
+	return -EINVAL;
+}
+#endif
 #endif /* __KERNEL__ */
 
 #define FUTEX_OP_SET		0	/* *(int *)UADDR2 = OPARG; */
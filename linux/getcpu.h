@@ -10,7 +10,9 @@
 
    It is only a private cache for vgetcpu(). It will change in future kernels.
    The user program must store this information per thread (__thread)
-   If you want 100% accurate information pass NULL instead. */
+   If you want 100% accurate information pass NULL instead, or read
+   cpu_id from a registered struct rseq (linux/rseq.h), which the kernel
+   keeps current on every return to user space. */
 struct getcpu_cache {
 	unsigned long blob[128 / sizeof(long)];
 };
@@ -22,6 +22,22 @@ struct page *ksm_does_need_to_copy(struct page *page,
 #ifdef CONFIG_KSM
 int ksm_madvise(struct vm_area_struct *vma, unsigned long start,
 		unsigned long end, int advice, unsigned long *vm_flags);
+
+/*
+ * Cheap content checksum ksmd keeps per rmap_item: a page whose checksum
+ * changed since the last pass is volatile and is not inserted into the
+ * unstable tree, and a checksum that matches no stable or unstable node
+ * rejects the page before any memcmp-based tree walk.
+ */
+u32 ksm_page_checksum(struct page *page);
+
+/*
+ * With merge_across_nodes cleared (the default on NUMA), ksmd keeps
+ * separate stable and unstable trees per node so that merging never
+ * replaces a local page by a remote one.
+ */
+extern unsigned int ksm_merge_across_nodes;
+
 int __ksm_enter(struct mm_struct *mm);
 void __ksm_exit(struct mm_struct *mm);
 
@@ -0,0 +1,63 @@
+#ifndef __LINUX_LOCKREF_H
+#define __LINUX_LOCKREF_H
+
+/*
+ * Locked reference counts.
+ *
+ * These are different from just plain atomic refcounts in that they
+ * are atomic with respect to the spinlock that goes with them.  In
+ * particular, there can be implementations that don't actually get
+ * the spinlock for the common decrement/increment operations, but they
+ * still have to check that the operation is done semantically as if
+ * the spinlock had been taken (using a cmpxchg operation that covers
+ * both the lock and the count word).
+ *
+ * With USE_CMPXCHG_LOCKREF the lock and the count share one 64-bit
+ * word, and lockref_get()/lockref_put_or_lock() update the count with a
+ * single cmpxchg as long as the lock is observed unlocked, so a get/put
+ * on an uncontended object never bounces the spinlock.
+ */
+
+#include <linux/spinlock.h>
+
+/*
+ * The cmpxchg path is only correct if spinlock_t is 4 bytes, so that
+ * lock and count both fit in lock_count.  The lock debugging options
+ * and GENERIC_LOCKBREAK make spinlock_t larger, and on UP it is empty;
+ * fall back to the spinlock in those configurations.
+ */
+#if defined(CONFIG_CMPXCHG_LOCKREF) && defined(CONFIG_SMP) && \
+	!defined(CONFIG_DEBUG_SPINLOCK) && !defined(CONFIG_DEBUG_LOCK_ALLOC) && \
+	!defined(CONFIG_GENERIC_LOCKBREAK)
+#define USE_CMPXCHG_LOCKREF	1
+#else
+#define USE_CMPXCHG_LOCKREF	0
+#endif
+
+struct lockref {
+	union {
+#if USE_CMPXCHG_LOCKREF
+		aligned_u64 lock_count;
+#endif
+		struct {
+			spinlock_t lock;
+			unsigned int count;
+		};
+	};
+};
+
+extern void lockref_get(struct lockref *);
+extern int lockref_get_not_zero(struct lockref *);
+extern int lockref_get_or_lock(struct lockref *);
+extern int lockref_put_or_lock(struct lockref *);
+
+extern void lockref_mark_dead(struct lockref *);
+extern int lockref_get_not_dead(struct lockref *);
+
+/* Must be called under spinlock for reliable results */
+static inline int __lockref_is_dead(const struct lockref *l)
+{
+	return ((int)l->count < 0);
+}
+
+#endif /* __LINUX_LOCKREF_H */
@@ -0,0 +1,33 @@
+/*
+ * MCS lock defines
+ *
+ * This file contains the main data structure and API definitions of MCS lock.
+ *
+ * The MCS lock (proposed by Mellor-Crummey and Scott) is a simple spin-lock
+ * with the desirable properties of being fair, and with each cpu trying
+ * to acquire the lock spinning on a local variable.
+ * It avoids expensive cache bouncings that common test-and-set spin-lock
+ * implementations incur.
+ *
+ * The mutex and rwsem slowpaths use it to serialize optimistic spinners,
+ * so that only the head of the queue polls the lock owner's cacheline.
+ */
+#ifndef __LINUX_MCS_SPINLOCK_H
+#define __LINUX_MCS_SPINLOCK_H
+
+struct mcs_spinlock {
+	struct mcs_spinlock *next;
+	int locked; /* 1 if lock acquired */
+	int count;  /* nesting count, see kernel/qspinlock.c */
+};
+
+/*
+ * mcs_spin_lock() is kept out of line (kernel/mcs_spinlock.c) so that
+ * perf can correctly account for the time spent spinning in it.
+ */
+extern void mcs_spin_lock(struct mcs_spinlock **lock,
+			  struct mcs_spinlock *node);
+extern void mcs_spin_unlock(struct mcs_spinlock **lock,
+			    struct mcs_spinlock *node);
+
+#endif /* __LINUX_MCS_SPINLOCK_H */
@@ -362,6 +362,10 @@ struct mm_struct {
 	spinlock_t		ioctx_lock;
 	struct hlist_head	ioctx_list;
 #endif
+#ifdef CONFIG_FUTEX_PRIVATE_HASH
+	/* Private hash for FUTEX_PRIVATE_FLAG ops, see PR_FUTEX_HASH */
+	struct futex_private_hash *futex_phash;
+#endif
 #ifdef CONFIG_MM_OWNER
 	/*
 	 * "owner" points to a task that is regarded as the canonical
@@ -161,6 +161,12 @@ static inline int is_unevictable_lru(enum lru_list lru)
 
 struct lruvec {
 	struct list_head lists[NR_LRU_LISTS];
+	/*
+	 * Number of pages that were activated or evicted from the
+	 * inactive list; the clock that refault distances are read
+	 * off.  See mm/workingset.c.
+	 */
+	atomic_long_t inactive_age;
 };
 
 /* Mask used at gathering information at once (see memcontrol.c) */
@@ -366,6 +372,17 @@ struct zone {
 	unsigned int		compact_considered;
 	unsigned int		compact_defer_shift;
 	int			compact_order_failed;
+
+	/*
+	 * pfns where the migrate and free scanners stopped last time,
+	 * so that incremental compaction picks up where it left off
+	 * instead of rescanning the same pageblocks.
+	 */
+	unsigned long		compact_cached_free_pfn;
+	unsigned long		compact_cached_migrate_pfn;
+
+	/* Set to true when the PB_migrate_skip bits should be cleared */
+	bool			compact_blockskip_flush;
 #endif
 
 	ZONE_PADDING(_pad1_)
@@ -666,6 +683,12 @@ typedef struct pglist_data {
 	struct task_struct *kswapd;
 	int kswapd_max_order;
 	enum zone_type classzone_idx;
+#ifdef CONFIG_COMPACTION
+	int kcompactd_max_order;
+	enum zone_type kcompactd_classzone_idx;
+	wait_queue_head_t kcompactd_wait;
+	struct task_struct *kcompactd;
+#endif
 } pg_data_t;
 
 #define node_present_pages(nid)	(NODE_DATA(nid)->node_present_pages)
@@ -227,12 +227,17 @@ static inline struct page *page_cache_alloc_readahead(struct address_space *x)
 
 typedef int filler_t(void *, struct page *);
 
+struct page *find_get_entry(struct address_space *mapping, pgoff_t offset);
 extern struct page * find_get_page(struct address_space *mapping,
 				pgoff_t index);
+struct page *find_lock_entry(struct address_space *mapping, pgoff_t offset);
 extern struct page * find_lock_page(struct address_space *mapping,
 				pgoff_t index);
 extern struct page * find_or_create_page(struct address_space *mapping,
 				pgoff_t index, gfp_t gfp_mask);
+unsigned find_get_entries(struct address_space *mapping, pgoff_t start,
+			  unsigned int nr_entries, struct page **entries,
+			  pgoff_t *indices);
 unsigned find_get_pages(struct address_space *mapping, pgoff_t start,
 			unsigned int nr_pages, struct page **pages);
 unsigned find_get_pages_contig(struct address_space *mapping, pgoff_t start,
@@ -302,6 +307,7 @@ static inline pgoff_t linear_page_index(struct vm_area_struct *vma,
 
 extern void __lock_page(struct page *page);
 extern int __lock_page_killable(struct page *page);
+extern int __lock_page_async(struct page *page, struct wait_bit_queue *wait);
 extern int __lock_page_or_retry(struct page *page, struct mm_struct *mm,
 				unsigned int flags);
 extern void unlock_page(struct page *page);
@@ -344,6 +350,21 @@ static inline int lock_page_killable(struct page *page)
 	return 0;
 }
 
+/*
+ * lock_page_async is like lock_page but never sleeps.  If the page is
+ * locked, @wait is queued on the page's waitqueue and -EIOCBRETRY is
+ * returned; @wait's wake function is then called once the page is
+ * unlocked and the caller is expected to retry.  Returns 0 if the page
+ * was locked.
+ */
+static inline int lock_page_async(struct page *page,
+				  struct wait_bit_queue *wait)
+{
+	if (!trylock_page(page))
+		return __lock_page_async(page, wait);
+	return 0;
+}
+
 /*
  * lock_page_or_retry - Lock the page, unless this would block and the
  * caller indicated that it can handle a retry.
@@ -362,6 +383,20 @@ static inline int lock_page_or_retry(struct page *page, struct mm_struct *mm,
 extern void wait_on_page_bit(struct page *page, int bit_nr);
 
 extern int wait_on_page_bit_killable(struct page *page, int bit_nr);
+extern int wait_on_page_bit_async(struct page *page, int bit_nr,
+				  struct wait_bit_queue *wait);
+
+/*
+ * Non-blocking variant of wait_on_page_locked for AIO: returns
+ * -EIOCBRETRY with @wait queued if the page is still locked.
+ */
+static inline int wait_on_page_locked_async(struct page *page,
+					    struct wait_bit_queue *wait)
+{
+	if (PageLocked(page))
+		return wait_on_page_bit_async(page, PG_locked, wait);
+	return 0;
+}
 
 static inline int wait_on_page_locked_killable(struct page *page)
 {
@@ -457,7 +492,7 @@ int add_to_page_cache_locked(struct page *page, struct address_space *mapping,
 int add_to_page_cache_lru(struct page *page, struct address_space *mapping,
 				pgoff_t index, gfp_t gfp_mask);
 extern void delete_from_page_cache(struct page *page);
-extern void __delete_from_page_cache(struct page *page);
+extern void __delete_from_page_cache(struct page *page, void *shadow);
 int replace_page_cache_page(struct page *old, struct page *new, gfp_t gfp_mask);
 
 /*
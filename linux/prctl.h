@@ -124,4 +124,13 @@
 #define PR_SET_CHILD_SUBREAPER 36
 #define PR_GET_CHILD_SUBREAPER 37
 
+/*
+ * Give the process its own hash table for FUTEX_PRIVATE_FLAG futexes
+ * instead of sharing the global one.  SET_SLOTS takes the number of
+ * buckets (a power of two, or 0 to go back to the global hash).
+ */
+#define PR_FUTEX_HASH			38
+# define PR_FUTEX_HASH_SET_SLOTS	1
+# define PR_FUTEX_HASH_GET_SLOTS	2
+
 #endif /* _LINUX_PRCTL_H */
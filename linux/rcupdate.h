@@ -191,6 +191,26 @@ extern void rcu_idle_exit(void);
 extern void rcu_irq_enter(void);
 extern void rcu_irq_exit(void);
 
+#ifdef CONFIG_RCU_NOCB_CPU
+/*
+ * CPUs named by the "rcu_nocbs=" boot parameter never invoke RCU
+ * callbacks from softirq.  call_rcu() and friends instead enqueue onto
+ * a lockless per-CPU list that is drained by an "rcuo" kthread, which
+ * may be affined to housekeeping CPUs.  With "rcu_nocb_poll" the
+ * kthreads poll their lists rather than being awakened by call_rcu().
+ */
+extern bool rcu_is_nocb_cpu(int cpu);
+extern void rcu_init_nohz(void);
+#else /* #ifdef CONFIG_RCU_NOCB_CPU */
+static inline bool rcu_is_nocb_cpu(int cpu)
+{
+	return false;
+}
+static inline void rcu_init_nohz(void)
+{
+}
+#endif /* #else #ifdef CONFIG_RCU_NOCB_CPU */
+
 /**
  * RCU_NONIDLE - Indicate idle-loop code that needs RCU readers
  * @a: Code that RCU needs to pay attention to.
@@ -17,6 +17,7 @@
 #include <linux/atomic.h>
 
 struct rw_semaphore;
+struct mcs_spinlock;
 
 #ifdef CONFIG_RWSEM_GENERIC_SPINLOCK
 #include <linux/rwsem-spinlock.h> /* use a generic implementation */
@@ -26,6 +27,15 @@ struct rw_semaphore {
 	long			count;
 	raw_spinlock_t		wait_lock;
 	struct list_head	wait_list;
+#ifdef CONFIG_RWSEM_SPIN_ON_OWNER
+	/*
+	 * Write owner, and the MCS queue of tasks optimistically spinning
+	 * on it.  While the owning writer is running on another CPU, a
+	 * contending writer spins rather than sleeping on wait_list.
+	 */
+	struct mcs_spinlock	*mcs_lock;
+	struct task_struct	*owner;
+#endif
 #ifdef CONFIG_DEBUG_LOCK_ALLOC
 	struct lockdep_map	dep_map;
 #endif
@@ -55,10 +65,17 @@ static inline int rwsem_is_locked(struct rw_semaphore *sem)
 # define __RWSEM_DEP_MAP_INIT(lockname)
 #endif
 
+#ifdef CONFIG_RWSEM_SPIN_ON_OWNER
+# define __RWSEM_OPT_INIT(lockname) , .mcs_lock = NULL, .owner = NULL
+#else
+# define __RWSEM_OPT_INIT(lockname)
+#endif
+
 #define __RWSEM_INITIALIZER(name)			\
 	{ RWSEM_UNLOCKED_VALUE,				\
 	  __RAW_SPIN_LOCK_UNLOCKED(name.wait_lock),	\
 	  LIST_HEAD_INIT((name).wait_list)		\
+	  __RWSEM_OPT_INIT(name)			\
 	  __RWSEM_DEP_MAP_INIT(name) }
 
 #define DECLARE_RWSEM(name) \
@@ -10,6 +10,16 @@ struct shrink_control {
 
 	/* How many slab objects shrinker() should scan and try to reclaim */
 	unsigned long nr_to_scan;
+
+	/* current node being shrunk (for SHRINKER_NUMA_AWARE shrinkers) */
+	int nid;
+
+	/*
+	 * The memory cgroup that is being reclaimed.  Only set for
+	 * SHRINKER_MEMCG_AWARE shrinkers during memcg reclaim; NULL means
+	 * global reclaim and objects of all cgroups may be freed.
+	 */
+	struct mem_cgroup *memcg;
 };
 
 /*
@@ -32,12 +42,19 @@ struct shrinker {
 	int (*shrink)(struct shrinker *, struct shrink_control *sc);
 	int seeks;	/* seeks to recreate an obj */
 	long batch;	/* reclaim batch size, 0 = default */
+	unsigned long flags;
 
 	/* These are for internal use */
 	struct list_head list;
-	atomic_long_t nr_in_batch; /* objs pending delete */
+	/* objs pending delete, per node for SHRINKER_NUMA_AWARE */
+	atomic_long_t *nr_deferred;
 };
 #define DEFAULT_SEEKS 2 /* A good number if you don't know better. */
-extern void register_shrinker(struct shrinker *);
+
+/* Flags */
+#define SHRINKER_MEMCG_AWARE (1 << 0)
+#define SHRINKER_NUMA_AWARE (1 << 1)
+
+extern int register_shrinker(struct shrinker *);
 extern void unregister_shrinker(struct shrinker *);
 #endif
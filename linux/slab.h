@@ -11,6 +11,7 @@
 
 #include <linux/gfp.h>
 #include <linux/types.h>
+#include <linux/workqueue.h>
 
 /*
  * Flags to pass to kmem_cache_create().
@@ -76,6 +77,12 @@
 # define SLAB_FAILSLAB		0x00000000UL
 #endif
 
+#ifdef CONFIG_CGROUP_MEM_RES_CTLR_KMEM
+# define SLAB_ACCOUNT		0x04000000UL	/* Account to memcg */
+#else
+# define SLAB_ACCOUNT		0x00000000UL
+#endif
+
 /* The following flags affect the page allocator grouping pages by mobility */
 #define SLAB_RECLAIM_ACCOUNT	0x00020000UL		/* Objects are reclaimable */
 #define SLAB_TEMPORARY		SLAB_RECLAIM_ACCOUNT	/* Objects are short-lived */
@@ -98,14 +105,49 @@
 void __init kmem_cache_init(void);
 int slab_is_available(void);
 
+struct mem_cgroup;
 struct kmem_cache *kmem_cache_create(const char *, size_t, size_t,
 			unsigned long,
 			void (*)(void *));
+struct kmem_cache *
+kmem_cache_create_memcg(struct mem_cgroup *, const char *, size_t, size_t,
+			unsigned long, void (*)(void *), struct kmem_cache *);
 void kmem_cache_destroy(struct kmem_cache *);
 int kmem_cache_shrink(struct kmem_cache *);
 void kmem_cache_free(struct kmem_cache *, void *);
 unsigned int kmem_cache_size(struct kmem_cache *);
 
+/*
+ * Caches created with SLAB_ACCOUNT get lazily instantiated per-memcg
+ * copies the first time a task in a kmem-limited cgroup allocates from
+ * them, so that the pages backing its objects are charged to that cgroup.
+ *
+ * @is_root_cache: true for the global cache, false for a memcg copy
+ * @memcg_caches: root only, the memcg copies indexed by memcg_cache_id()
+ * @memcg: memcg copy only, the owning cgroup
+ * @list: memcg copy only, link in the owning memcg's list of caches
+ * @root_cache: memcg copy only, the cache this one was cloned from
+ * @dead: memcg copy only, the owning memcg is gone; destroy when empty
+ * @nr_pages: memcg copy only, number of pages still charged to @memcg
+ * @destroy: memcg copy only, deferred destruction work
+ */
+struct memcg_cache_params {
+	bool is_root_cache;
+	union {
+		struct kmem_cache *memcg_caches[0];
+		struct {
+			struct mem_cgroup *memcg;
+			struct list_head list;
+			struct kmem_cache *root_cache;
+			bool dead;
+			atomic_t nr_pages;
+			struct work_struct destroy;
+		};
+	};
+};
+
+int memcg_update_all_caches(int num_memcgs);
+
 /*
  * Please use this macro to create slab caches. Simply specify the
  * name of the structure and maybe some flags that are listed above.
@@ -110,6 +110,9 @@ struct kmem_cache {
 	int remote_node_defrag_ratio;
 #endif
 	struct kmem_cache_node *node[MAX_NUMNODES];
+#ifdef CONFIG_CGROUP_MEM_RES_CTLR_KMEM
+	struct memcg_cache_params *memcg_params;
+#endif
 };
 
 /*
@@ -37,9 +37,17 @@ enum vm_event_item { PGPGIN, PGPGOUT, PSWPIN, PSWPOUT,
 		KSWAPD_LOW_WMARK_HIT_QUICKLY, KSWAPD_HIGH_WMARK_HIT_QUICKLY,
 		KSWAPD_SKIP_CONGESTION_WAIT,
 		PAGEOUTRUN, ALLOCSTALL, PGROTATED,
+		WORKINGSET_REFAULT,	/* page cache refault of a shadow entry */
+		WORKINGSET_ACTIVATE,	/* refault activated straight away */
 #ifdef CONFIG_COMPACTION
 		COMPACTBLOCKS, COMPACTPAGES, COMPACTPAGEFAILED,
 		COMPACTSTALL, COMPACTFAIL, COMPACTSUCCESS,
+		KCOMPACTD_WAKE,
+#endif
+#ifdef CONFIG_KSM
+		KSM_PAGES_SCANNED,	/* pages looked at by ksmd */
+		KSM_CHECKSUM_SKIPPED,	/* rejected by checksum before tree walk */
+		KSM_VOLATILE_SKIPPED,	/* changed since the previous pass */
 #endif
 #ifdef CONFIG_HUGETLB_PAGE
 		HTLB_BUDDY_PGALLOC, HTLB_BUDDY_PGALLOC_FAIL,
@@ -3,6 +3,9 @@
 
 #include <linux/spinlock.h>
 #include <linux/init.h>
+#include <linux/list.h>
+#include <linux/rbtree.h>
+#include <linux/llist.h>
 #include <asm/page.h>		/* pgprot_t */
 
 struct vm_area_struct;		/* vma defining user mapping in mm_types.h */
@@ -35,6 +38,35 @@ struct vm_struct {
 	void			*caller;
 };
 
+/*
+ * Busy and free vmap_areas are kept in address-sorted rbtrees.  The free
+ * tree is augmented with subtree_max_size, the largest free gap below
+ * each node, so the lowest fitting area is found in O(log n) without
+ * walking the busy list under vmap_area_lock.
+ *
+ * Freed areas are not unmapped with a TLB shootdown each; they are queued
+ * on purge_list and flushed together once enough address space is
+ * pending, with a single flush_tlb_kernel_range() covering the whole
+ * batch.  vm_unmap_aliases() forces that flush.
+ */
+struct vmap_area {
+	unsigned long va_start;
+	unsigned long va_end;
+
+	/*
+	 * Largest available free size in this subtree; only valid
+	 * while the area sits in the free tree.
+	 */
+	unsigned long subtree_max_size;
+
+	unsigned long flags;
+	struct rb_node rb_node;         /* address sorted rbtree */
+	struct list_head list;          /* address sorted list */
+	struct llist_node purge_list;   /* lazily purged, batched flush */
+	struct vm_struct *vm;
+	struct rcu_head rcu_head;
+};
+
 /*
  *	Highlevel APIs for driver use
  */
@@ -67,6 +67,117 @@ TRACE_EVENT(mm_compaction_migratepages,
 		__entry->nr_failed)
 );
 
+TRACE_EVENT(mm_compaction_begin,
+
+	TP_PROTO(unsigned long zone_start, unsigned long migrate_start,
+		unsigned long free_start, unsigned long zone_end),
+
+	TP_ARGS(zone_start, migrate_start, free_start, zone_end),
+
+	TP_STRUCT__entry(
+		__field(unsigned long, zone_start)
+		__field(unsigned long, migrate_start)
+		__field(unsigned long, free_start)
+		__field(unsigned long, zone_end)
+	),
+
+	TP_fast_assign(
+		__entry->zone_start = zone_start;
+		__entry->migrate_start = migrate_start;
+		__entry->free_start = free_start;
+		__entry->zone_end = zone_end;
+	),
+
+	TP_printk("zone_start=%lu migrate_start=%lu free_start=%lu zone_end=%lu",
+		__entry->zone_start,
+		__entry->migrate_start,
+		__entry->free_start,
+		__entry->zone_end)
+);
+
+TRACE_EVENT(mm_compaction_end,
+
+	TP_PROTO(int status, u64 duration_ns),
+
+	TP_ARGS(status, duration_ns),
+
+	TP_STRUCT__entry(
+		__field(int, status)
+		__field(u64, duration_ns)
+	),
+
+	TP_fast_assign(
+		__entry->status = status;
+		__entry->duration_ns = duration_ns;
+	),
+
+	TP_printk("status=%d duration_ns=%llu",
+		__entry->status,
+		(unsigned long long)__entry->duration_ns)
+);
+
+DECLARE_EVENT_CLASS(kcompactd_wake_template,
+
+	TP_PROTO(int nid, int order, enum zone_type classzone_idx),
+
+	TP_ARGS(nid, order, classzone_idx),
+
+	TP_STRUCT__entry(
+		__field(int, nid)
+		__field(int, order)
+		__field(enum zone_type, classzone_idx)
+	),
+
+	TP_fast_assign(
+		__entry->nid = nid;
+		__entry->order = order;
+		__entry->classzone_idx = classzone_idx;
+	),
+
+	TP_printk("nid=%d order=%d classzone_idx=%d",
+		__entry->nid,
+		__entry->order,
+		__entry->classzone_idx)
+);
+
+DEFINE_EVENT(kcompactd_wake_template, mm_compaction_wakeup_kcompactd,
+
+	TP_PROTO(int nid, int order, enum zone_type classzone_idx),
+
+	TP_ARGS(nid, order, classzone_idx)
+);
+
+DEFINE_EVENT(kcompactd_wake_template, mm_compaction_kcompactd_wake,
+
+	TP_PROTO(int nid, int order, enum zone_type classzone_idx),
+
+	TP_ARGS(nid, order, classzone_idx)
+);
+
+TRACE_EVENT(mm_compaction_kcompactd_sleep,
+
+	TP_PROTO(int nid, unsigned long nr_attempted,
+		unsigned long nr_succeeded),
+
+	TP_ARGS(nid, nr_attempted, nr_succeeded),
+
+	TP_STRUCT__entry(
+		__field(int, nid)
+		__field(unsigned long, nr_attempted)
+		__field(unsigned long, nr_succeeded)
+	),
+
+	TP_fast_assign(
+		__entry->nid = nid;
+		__entry->nr_attempted = nr_attempted;
+		__entry->nr_succeeded = nr_succeeded;
+	),
+
+	TP_printk("nid=%d nr_attempted=%lu nr_succeeded=%lu",
+		__entry->nid,
+		__entry->nr_attempted,
+		__entry->nr_succeeded)
+);
 
 #endif /* _TRACE_COMPACTION_H */
 
@@ -0,0 +1,98 @@
+#undef TRACE_SYSTEM
+#define TRACE_SYSTEM ksm
+
+#if !defined(_TRACE_KSM_H) || defined(TRACE_HEADER_MULTI_READ)
+#define _TRACE_KSM_H
+
+#include <linux/types.h>
+#include <linux/tracepoint.h>
+
+/*
+ * ksmd emits one ksm_start_scan/ksm_stop_scan pair per batch of
+ * pages_to_scan pages; pages scanned per second and the CPU cost of a
+ * full pass can be derived from the sequence of stop events.
+ */
+TRACE_EVENT(ksm_start_scan,
+
+	TP_PROTO(unsigned long seqnr, unsigned long pages_to_scan),
+
+	TP_ARGS(seqnr, pages_to_scan),
+
+	TP_STRUCT__entry(
+		__field(unsigned long, seqnr)
+		__field(unsigned long, pages_to_scan)
+	),
+
+	TP_fast_assign(
+		__entry->seqnr = seqnr;
+		__entry->pages_to_scan = pages_to_scan;
+	),
+
+	TP_printk("seqnr=%lu pages_to_scan=%lu",
+		__entry->seqnr,
+		__entry->pages_to_scan)
+);
+
+TRACE_EVENT(ksm_stop_scan,
+
+	TP_PROTO(unsigned long seqnr, unsigned long nr_scanned,
+		unsigned long nr_checksum_skipped, unsigned long nr_merged,
+		u64 runtime_ns),
+
+	TP_ARGS(seqnr, nr_scanned, nr_checksum_skipped, nr_merged, runtime_ns),
+
+	TP_STRUCT__entry(
+		__field(unsigned long, seqnr)
+		__field(unsigned long, nr_scanned)
+		__field(unsigned long, nr_checksum_skipped)
+		__field(unsigned long, nr_merged)
+		__field(u64, runtime_ns)
+	),
+
+	TP_fast_assign(
+		__entry->seqnr = seqnr;
+		__entry->nr_scanned = nr_scanned;
+		__entry->nr_checksum_skipped = nr_checksum_skipped;
+		__entry->nr_merged = nr_merged;
+		__entry->runtime_ns = runtime_ns;
+	),
+
+	TP_printk("seqnr=%lu nr_scanned=%lu nr_checksum_skipped=%lu nr_merged=%lu runtime_ns=%llu",
+		__entry->seqnr,
+		__entry->nr_scanned,
+		__entry->nr_checksum_skipped,
+		__entry->nr_merged,
+		(unsigned long long)__entry->runtime_ns)
+);
+
+TRACE_EVENT(ksm_merge_one_page,
+
+	TP_PROTO(unsigned long pfn, unsigned long kpfn, int nid, int err),
+
+	TP_ARGS(pfn, kpfn, nid, err),
+
+	TP_STRUCT__entry(
+		__field(unsigned long, pfn)
+		__field(unsigned long, kpfn)
+		__field(int, nid)
+		__field(int, err)
+	),
+
+	TP_fast_assign(
+		__entry->pfn = pfn;
+		__entry->kpfn = kpfn;
+		__entry->nid = nid;
+		__entry->err = err;
+	),
+
+	TP_printk("pfn=0x%lx kpfn=0x%lx nid=%d err=%d",
+		__entry->pfn,
+		__entry->kpfn,
+		__entry->nid,
+		__entry->err)
+);
+
+#endif /* _TRACE_KSM_H */
+
+/* This part must be outside protection */
+#include <trace/define_trace.h>
@@ -513,6 +513,78 @@ TRACE_EVENT(rcu_batch_end,
 		  __entry->risk ? 'R' : '.')
 );
 
+/*
+ * Tracepoint for the no-CBs CPU callback-offload kthreads.  The first
+ * argument is the name of the RCU flavor, the second is the CPU whose
+ * callbacks are being offloaded, and the third is a string describing
+ * the event:
+ *
+ *	"WakeEmpty": call_rcu() awakened the kthread on an empty list.
+ *	"WakeNot": call_rcu() queued a callback without a wakeup.
+ *	"Poll": The kthread is polling for callbacks (rcu_nocb_poll).
+ *	"Sleep": The kthread found no callbacks and is going to sleep.
+ *	"WokeEmpty": The kthread awakened to find an empty list.
+ *	"WokeNonEmpty": The kthread awakened to find callbacks.
+ *	"CBSleep": The kthread is waiting for a grace period to elapse.
+ *	"CBWoke": The grace period ended; invoking callbacks.
+ */
+TRACE_EVENT(rcu_nocb_wake,
+
+	TP_PROTO(char *rcuname, int cpu, char *reason),
+
+	TP_ARGS(rcuname, cpu, reason),
+
+	TP_STRUCT__entry(
+		__field(char *, rcuname)
+		__field(int, cpu)
+		__field(char *, reason)
+	),
+
+	TP_fast_assign(
+		__entry->rcuname = rcuname;
+		__entry->cpu = cpu;
+		__entry->reason = reason;
+	),
+
+	TP_printk("%s %d %s", __entry->rcuname, __entry->cpu, __entry->reason)
+);
+
+/*
+ * Tracepoint for a no-CBs kthread finishing one batch of offloaded
+ * callbacks.  The first argument is the name of the RCU flavor, the
+ * second is the CPU that queued the callbacks, the third and fourth
+ * are the number of lazy and total callbacks invoked, and the fifth
+ * is the latency in jiffies from the enqueue of the oldest callback
+ * in the batch to the start of its invocation.
+ */
+TRACE_EVENT(rcu_nocb_batch,
+
+	TP_PROTO(char *rcuname, int cpu, long count_lazy, long count,
+		 unsigned long latency),
+
+	TP_ARGS(rcuname, cpu, count_lazy, count, latency),
+
+	TP_STRUCT__entry(
+		__field(char *, rcuname)
+		__field(int, cpu)
+		__field(long, count_lazy)
+		__field(long, count)
+		__field(unsigned long, latency)
+	),
+
+	TP_fast_assign(
+		__entry->rcuname = rcuname;
+		__entry->cpu = cpu;
+		__entry->count_lazy = count_lazy;
+		__entry->count = count;
+		__entry->latency = latency;
+	),
+
+	TP_printk("%s %d CBs=%ld/%ld latency=%lu",
+		  __entry->rcuname, __entry->cpu, __entry->count_lazy,
+		  __entry->count, __entry->latency)
+);
+
 /*
  * Tracepoint for rcutorture readers.  The first argument is the name
  * of the RCU flavor from rcutorture's viewpoint and the second argument
@@ -560,6 +632,9 @@ TRACE_EVENT(rcu_torture_read,
 #define trace_rcu_invoke_kfree_callback(rcuname, rhp, offset) do { } while (0)
 #define trace_rcu_batch_end(rcuname, callbacks_invoked, cb, nr, iit, risk) \
 	do { } while (0)
+#define trace_rcu_nocb_wake(rcuname, cpu, reason) do { } while (0)
+#define trace_rcu_nocb_batch(rcuname, cpu, count_lazy, count, latency) \
+	do { } while (0)
 #define trace_rcu_torture_read(rcutorturename, rhp) do { } while (0)
 
 #endif /* #else #ifdef CONFIG_RCU_TRACE */